@@ -0,0 +1,376 @@
+#include "HistoryStore.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace
+{
+    // Worst case for one reading: 4 + 64 timestamp bits and 2 + 5 + 6 + 64 value bits.
+    const size_t MAX_BITS_PER_READING = 145;
+
+    uint64_t doubleToBits(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    double bitsToDouble(uint64_t bits)
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    int countLeadingZeros(uint64_t x)
+    {
+        int n = 0;
+        while (n < 64 && !(x & (1ULL << (63 - n))))
+            n++;
+        return n;
+    }
+
+    int countTrailingZeros(uint64_t x)
+    {
+        int n = 0;
+        while (n < 64 && !(x & (1ULL << n)))
+            n++;
+        return n;
+    }
+
+    class BitReader
+    {
+    private:
+        const uint8_t *data;
+        size_t position = 0;
+
+    public:
+        explicit BitReader(const uint8_t *data) : data(data) {}
+
+        uint64_t read(int bitCount)
+        {
+            uint64_t value = 0;
+            for (int i = 0; i < bitCount; ++i)
+            {
+                uint64_t bit = (data[position >> 3] >> (7 - (position & 7))) & 1;
+                value = (value << 1) | bit;
+                position++;
+            }
+            return value;
+        }
+
+        // Counts leading '1' control bits, stopping after maxOnes or at the first '0'.
+        int readControl(int maxOnes)
+        {
+            int ones = 0;
+            while (ones < maxOnes && read(1) == 1)
+                ones++;
+            return ones;
+        }
+    };
+}
+
+HistoryStore::HistoryStore(int64_t retentionMs, int mantissaBits) : retentionMs(retentionMs)
+{
+    mantissaBits = std::max(0, std::min(52, mantissaBits));
+    int droppedBits = 52 - mantissaBits;
+    valueMask = droppedBits == 0 ? ~0ULL : ~((1ULL << droppedBits) - 1);
+}
+
+void HistoryStore::writeBits(Block &block, uint64_t value, int bitCount)
+{
+    for (int i = bitCount - 1; i >= 0; --i)
+    {
+        if ((value >> i) & 1)
+        {
+            block.bits[block.bitLength >> 3] |= static_cast<uint8_t>(0x80 >> (block.bitLength & 7));
+        }
+        block.bitLength++;
+    }
+}
+
+void HistoryStore::encodeTimestamp(Block &block, int64_t timestamp)
+{
+    int64_t delta = timestamp - block.prevTimestamp;
+    int64_t deltaOfDelta = delta - block.prevDelta;
+    uint64_t zigzag = (static_cast<uint64_t>(deltaOfDelta) << 1) ^ static_cast<uint64_t>(deltaOfDelta >> 63);
+
+    if (zigzag == 0)
+    {
+        writeBits(block, 0b0, 1);
+    }
+    else if (zigzag < (1ULL << 7))
+    {
+        writeBits(block, 0b10, 2);
+        writeBits(block, zigzag, 7);
+    }
+    else if (zigzag < (1ULL << 9))
+    {
+        writeBits(block, 0b110, 3);
+        writeBits(block, zigzag, 9);
+    }
+    else if (zigzag < (1ULL << 12))
+    {
+        writeBits(block, 0b1110, 4);
+        writeBits(block, zigzag, 12);
+    }
+    else
+    {
+        writeBits(block, 0b1111, 4);
+        writeBits(block, zigzag, 64);
+    }
+
+    block.prevDelta = delta;
+    block.prevTimestamp = timestamp;
+}
+
+void HistoryStore::encodeValue(Block &block, uint64_t valueBits)
+{
+    uint64_t xorBits = valueBits ^ block.prevValueBits;
+    block.prevValueBits = valueBits;
+
+    if (xorBits == 0)
+    {
+        writeBits(block, 0b0, 1);
+        return;
+    }
+
+    int leading = std::min(31, countLeadingZeros(xorBits));
+    int trailing = countTrailingZeros(xorBits);
+
+    if (block.prevLeading >= 0 && leading >= block.prevLeading && trailing >= block.prevTrailing)
+    {
+        int meaningful = 64 - block.prevLeading - block.prevTrailing;
+        writeBits(block, 0b10, 2);
+        writeBits(block, xorBits >> block.prevTrailing, meaningful);
+        return;
+    }
+
+    int meaningful = 64 - leading - trailing;
+    writeBits(block, 0b11, 2);
+    writeBits(block, leading, 5);
+    writeBits(block, meaningful - 1, 6);
+    writeBits(block, xorBits >> trailing, meaningful);
+    block.prevLeading = leading;
+    block.prevTrailing = trailing;
+}
+
+template <typename Visitor>
+void HistoryStore::decodeBlock(const Block &block, Visitor &&visit)
+{
+    if (block.count == 0)
+    {
+        return;
+    }
+
+    BitReader reader(block.bits.data());
+    int64_t timestamp = block.firstTimestamp;
+    int64_t delta = 0;
+    uint64_t valueBits = block.firstValueBits;
+    int leading = 0;
+    int trailing = 0;
+
+    visit(timestamp, bitsToDouble(valueBits));
+
+    for (int i = 1; i < block.count; ++i)
+    {
+        uint64_t zigzag = 0;
+        switch (reader.readControl(4))
+        {
+        case 0:
+            break;
+        case 1:
+            zigzag = reader.read(7);
+            break;
+        case 2:
+            zigzag = reader.read(9);
+            break;
+        case 3:
+            zigzag = reader.read(12);
+            break;
+        default:
+            zigzag = reader.read(64);
+            break;
+        }
+        int64_t deltaOfDelta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        delta += deltaOfDelta;
+        timestamp += delta;
+
+        if (reader.read(1) == 1)
+        {
+            if (reader.read(1) == 1)
+            {
+                leading = static_cast<int>(reader.read(5));
+                int meaningful = static_cast<int>(reader.read(6)) + 1;
+                trailing = 64 - leading - meaningful;
+            }
+            int meaningful = 64 - leading - trailing;
+            valueBits ^= reader.read(meaningful) << trailing;
+        }
+
+        visit(timestamp, bitsToDouble(valueBits));
+    }
+}
+
+void HistoryStore::append(const SensorReading &reading)
+{
+    std::deque<Block> &blocks = sensorBlocks[reading.sensorID];
+    uint64_t valueBits = doubleToBits(reading.temperature) & valueMask;
+
+    bool startedBlock = false;
+    bool firstBlock = blocks.empty();
+    if (firstBlock || blocks.back().bitLength + MAX_BITS_PER_READING > BLOCK_BYTES * 8)
+    {
+        blocks.emplace_back();
+        startedBlock = true;
+    }
+
+    Block &block = blocks.back();
+    if (block.count == 0)
+    {
+        block.firstTimestamp = reading.timestamp;
+        block.firstValueBits = valueBits;
+        block.prevTimestamp = reading.timestamp;
+        block.prevValueBits = valueBits;
+        block.minTimestamp = reading.timestamp;
+        block.maxTimestamp = reading.timestamp;
+    }
+    else
+    {
+        encodeTimestamp(block, reading.timestamp);
+        encodeValue(block, valueBits);
+        block.minTimestamp = std::min(block.minTimestamp, static_cast<int64_t>(reading.timestamp));
+        block.maxTimestamp = std::max(block.maxTimestamp, static_cast<int64_t>(reading.timestamp));
+    }
+    block.count++;
+
+    if (firstBlock)
+    {
+        frontBlockQueue.push(std::make_pair(block.maxTimestamp, reading.sensorID));
+    }
+
+    newestTimestamp = std::max(newestTimestamp, static_cast<int64_t>(reading.timestamp));
+    if (startedBlock)
+    {
+        evictExpiredBlocks();
+    }
+}
+
+// Drops whole blocks older than the retention period; runs only when a block is started
+// and only visits sensors whose front block may have expired.
+void HistoryStore::evictExpiredBlocks()
+{
+    int64_t cutoff = newestTimestamp - retentionMs;
+    while (!frontBlockQueue.empty() && frontBlockQueue.top().first < cutoff)
+    {
+        std::pair<int64_t, int> entry = frontBlockQueue.top();
+        frontBlockQueue.pop();
+
+        auto found = sensorBlocks.find(entry.second);
+        if (found == sensorBlocks.end())
+        {
+            continue;
+        }
+        std::deque<Block> &blocks = found->second;
+        if (blocks.front().maxTimestamp != entry.first)
+        {
+            frontBlockQueue.push(std::make_pair(blocks.front().maxTimestamp, entry.second));
+            continue;
+        }
+
+        blocks.pop_front();
+        evictedBlocks++;
+        if (blocks.empty())
+        {
+            sensorBlocks.erase(found);
+        }
+        else
+        {
+            frontBlockQueue.push(std::make_pair(blocks.front().maxTimestamp, entry.second));
+        }
+    }
+}
+
+size_t HistoryStore::scanRange(int sensorID, int64_t fromTimestamp, int64_t toTimestamp, std::vector<SensorReading> &out) const
+{
+    auto found = sensorBlocks.find(sensorID);
+    if (found == sensorBlocks.end())
+    {
+        return 0;
+    }
+
+    size_t matched = 0;
+    for (const Block &block : found->second)
+    {
+        if (block.maxTimestamp < fromTimestamp || block.minTimestamp > toTimestamp)
+        {
+            continue;
+        }
+        decodeBlock(block, [&](int64_t timestamp, double temperature)
+                    {
+            if (timestamp >= fromTimestamp && timestamp <= toTimestamp)
+            {
+                out.push_back(SensorReading{sensorID, timestamp, temperature});
+                matched++;
+            } });
+    }
+    return matched;
+}
+
+std::vector<HistoryBucket> HistoryStore::downsample(int sensorID, int64_t fromTimestamp, int64_t toTimestamp, int64_t bucketMs) const
+{
+    std::vector<HistoryBucket> result;
+    auto found = sensorBlocks.find(sensorID);
+    if (found == sensorBlocks.end() || bucketMs <= 0)
+    {
+        return result;
+    }
+
+    std::map<int64_t, HistoryBucket> buckets;
+    for (const Block &block : found->second)
+    {
+        if (block.maxTimestamp < fromTimestamp || block.minTimestamp > toTimestamp)
+        {
+            continue;
+        }
+        decodeBlock(block, [&](int64_t timestamp, double temperature)
+                    {
+            if (timestamp < fromTimestamp || timestamp > toTimestamp)
+            {
+                return;
+            }
+            int64_t bucketStart = fromTimestamp + (timestamp - fromTimestamp) / bucketMs * bucketMs;
+            auto inserted = buckets.emplace(bucketStart, HistoryBucket{bucketStart, 0, temperature, temperature, 0.0});
+            HistoryBucket &bucket = inserted.first->second;
+            bucket.count++;
+            bucket.minTemperature = std::min(bucket.minTemperature, temperature);
+            bucket.maxTemperature = std::max(bucket.maxTemperature, temperature);
+            bucket.meanTemperature += temperature; });
+    }
+
+    result.reserve(buckets.size());
+    for (auto &entry : buckets)
+    {
+        entry.second.meanTemperature /= entry.second.count;
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+HistoryStats HistoryStore::getStats() const
+{
+    HistoryStats stats;
+    stats.sensors = sensorBlocks.size();
+    stats.evictedBlocks = evictedBlocks;
+    for (const auto &entry : sensorBlocks)
+    {
+        stats.blocks += entry.second.size();
+        for (const Block &block : entry.second)
+        {
+            stats.readings += block.count;
+            stats.payloadBytes += (block.bitLength + 7) / 8;
+        }
+    }
+    stats.allocatedBytes = stats.blocks * sizeof(Block);
+    return stats;
+}
@@ -0,0 +1,85 @@
+#ifndef HISTORYSTORE_HPP
+#define HISTORYSTORE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "SensorReading.hpp"
+
+struct HistoryBucket
+{
+    int64_t bucketStart;
+    int count;
+    double minTemperature;
+    double maxTemperature;
+    double meanTemperature;
+};
+
+struct HistoryStats
+{
+    size_t sensors = 0;
+    size_t blocks = 0;
+    unsigned long long readings = 0;
+    unsigned long long payloadBytes = 0;   // encoded bits only
+    unsigned long long allocatedBytes = 0; // whole blocks, including partly filled ones and block metadata
+    unsigned long long evictedBlocks = 0;
+};
+
+// Per-sensor history of expired readings. Timestamps are stored as delta-of-delta and
+// temperatures as XOR against the previous value (Gorilla encoding) in fixed-size blocks.
+class HistoryStore
+{
+public:
+    static const size_t BLOCK_BYTES = 512;
+
+private:
+    struct Block
+    {
+        std::array<uint8_t, BLOCK_BYTES> bits{};
+        size_t bitLength = 0;
+        int count = 0;
+        int64_t minTimestamp = 0;
+        int64_t maxTimestamp = 0;
+
+        int64_t firstTimestamp = 0;
+        uint64_t firstValueBits = 0;
+        int64_t prevTimestamp = 0;
+        int64_t prevDelta = 0;
+        uint64_t prevValueBits = 0;
+        int prevLeading = -1;
+        int prevTrailing = 0;
+    };
+
+    std::unordered_map<int, std::deque<Block>> sensorBlocks;
+    // One (front block maxTimestamp, sensorID) entry per sensor. An entry goes stale when
+    // its front block keeps growing; it is refreshed lazily when it reaches the top.
+    std::priority_queue<std::pair<int64_t, int>, std::vector<std::pair<int64_t, int>>,
+                        std::greater<std::pair<int64_t, int>>>
+        frontBlockQueue;
+    int64_t retentionMs;
+    uint64_t valueMask;
+    int64_t newestTimestamp = INT64_MIN;
+    unsigned long long evictedBlocks = 0;
+
+    static void writeBits(Block &block, uint64_t value, int bitCount);
+    static void encodeTimestamp(Block &block, int64_t timestamp);
+    static void encodeValue(Block &block, uint64_t valueBits);
+    template <typename Visitor>
+    static void decodeBlock(const Block &block, Visitor &&visit);
+    void evictExpiredBlocks();
+
+public:
+    HistoryStore(int64_t retentionMs, int mantissaBits = 52);
+    void append(const SensorReading &reading);
+    size_t scanRange(int sensorID, int64_t fromTimestamp, int64_t toTimestamp, std::vector<SensorReading> &out) const;
+    std::vector<HistoryBucket> downsample(int sensorID, int64_t fromTimestamp, int64_t toTimestamp, int64_t bucketMs) const;
+    HistoryStats getStats() const;
+};
+
+#endif
@@ -0,0 +1,657 @@
+#include "IngestionFrontend.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+namespace
+{
+    const size_t HANDOFF_BATCH_SIZE = 4096;
+    const size_t RECV_BATCH_MESSAGES = 64;
+    const size_t DATAGRAM_BUFFER_BYTES = 2048;
+    const size_t STREAM_LINE_BUFFER_BYTES = 256;
+    const size_t STREAM_READ_BYTES = 65536;
+    const int MAX_EPOLL_EVENTS = 64;
+    const int MAX_RECV_ROUNDS_PER_EVENT = 16;
+    const int ACCEPT_BACKOFF_MS = 100;
+
+    long long steadyNowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    const char *skipSpaces(const char *p, const char *end)
+    {
+        while (p < end && (*p == ' ' || *p == '\t'))
+        {
+            ++p;
+        }
+        return p;
+    }
+
+    template <typename T>
+    const char *parseField(const char *p, const char *end, T &value)
+    {
+        p = skipSpaces(p, end);
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc())
+        {
+            return nullptr;
+        }
+        return skipSpaces(result.ptr, end);
+    }
+}
+
+bool parseReadingLine(const char *begin, const char *end, SensorReading &reading)
+{
+    while (end > begin && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+    {
+        --end;
+    }
+
+    int sensorID = 0;
+    int64_t timestamp = 0;
+    double temperature = 0.0;
+
+    const char *p = parseField(begin, end, sensorID);
+    if (p == nullptr || p == end || *p != ',')
+    {
+        return false;
+    }
+    p = parseField(p + 1, end, timestamp);
+    if (p == nullptr || p == end || *p != ',')
+    {
+        return false;
+    }
+    p = parseField(p + 1, end, temperature);
+    if (p == nullptr || p != end || !std::isfinite(temperature))
+    {
+        return false;
+    }
+
+    reading.sensorID = sensorID;
+    reading.timestamp = timestamp;
+    reading.temperature = temperature;
+    return true;
+}
+
+FrontendCounters IngestionFrontend::getCounters() const
+{
+    FrontendCounters c;
+    c.readingsParsed = readingsParsed.load(std::memory_order_relaxed);
+    c.parseErrors = parseErrors.load(std::memory_order_relaxed);
+    c.outOfRangeReadings = outOfRangeReadings.load(std::memory_order_relaxed);
+    c.datagramsReceived = datagramsReceived.load(std::memory_order_relaxed);
+    c.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+    c.batchesHandedOff = batchesHandedOff.load(std::memory_order_relaxed);
+    c.acceptRetries = acceptRetries.load(std::memory_order_relaxed);
+    c.acceptBackoffs = acceptBackoffs.load(std::memory_order_relaxed);
+    return c;
+}
+
+// Cached once per event-loop pass rather than read for every reading.
+void IngestionFrontend::refreshValidationClock()
+{
+    validationNowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+}
+
+// Keeps network input within the bounds processReading and HistoryStore assume, so
+// timestamp arithmetic downstream cannot overflow.
+bool IngestionFrontend::isAcceptable(const SensorReading &reading) const
+{
+    if (reading.sensorID < minSensorID || reading.sensorID > maxSensorID)
+    {
+        return false;
+    }
+    return reading.timestamp >= validationNowMs - timestampToleranceMs &&
+           reading.timestamp <= validationNowMs + timestampToleranceMs;
+}
+
+void IngestionFrontend::appendReading(const SensorReading &reading)
+{
+    pendingBatch.push_back(reading);
+    if (pendingBatch.size() >= HANDOFF_BATCH_SIZE)
+    {
+        flushBatch();
+    }
+}
+
+void IngestionFrontend::flushBatch()
+{
+    if (pendingBatch.empty())
+    {
+        return;
+    }
+    readingQueue.pushBatch(pendingBatch.data(), pendingBatch.size());
+    readingsParsed.fetch_add(pendingBatch.size(), std::memory_order_relaxed);
+    batchesHandedOff.fetch_add(1, std::memory_order_relaxed);
+    pendingBatch.clear();
+}
+
+// Parses a buffer holding only complete lines, e.g. a single datagram.
+void IngestionFrontend::parseChunk(const char *data, size_t length)
+{
+    const char *p = data;
+    const char *end = data + length;
+    while (p < end)
+    {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (lineEnd == nullptr)
+        {
+            lineEnd = end;
+        }
+        if (lineEnd > p)
+        {
+            SensorReading reading;
+            if (parseReadingLine(p, lineEnd, reading))
+            {
+                if (isAcceptable(reading))
+                {
+                    appendReading(reading);
+                }
+                else
+                {
+                    outOfRangeReadings.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                parseErrors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        p = lineEnd + 1;
+    }
+}
+
+// Parses stream bytes, carrying a partial trailing line over to the next read.
+void IngestionFrontend::consumeStreamBytes(Source &source, const char *data, size_t length)
+{
+    const char *p = data;
+    const char *end = data + length;
+    while (p < end)
+    {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (lineEnd == nullptr)
+        {
+            size_t remaining = end - p;
+            if (source.discardingLine)
+            {
+                return;
+            }
+            if (source.lineLength + remaining > source.lineBuffer.size())
+            {
+                parseErrors.fetch_add(1, std::memory_order_relaxed);
+                source.lineLength = 0;
+                source.discardingLine = true;
+                return;
+            }
+            std::memcpy(source.lineBuffer.data() + source.lineLength, p, remaining);
+            source.lineLength += remaining;
+            return;
+        }
+
+        if (source.discardingLine)
+        {
+            source.discardingLine = false;
+        }
+        else if (source.lineLength > 0)
+        {
+            size_t part = lineEnd - p;
+            if (source.lineLength + part > source.lineBuffer.size())
+            {
+                parseErrors.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                std::memcpy(source.lineBuffer.data() + source.lineLength, p, part);
+                parseChunk(source.lineBuffer.data(), source.lineLength + part);
+            }
+        }
+        else if (static_cast<size_t>(lineEnd - p) > source.lineBuffer.size())
+        {
+            // Same limit as a line reassembled across reads.
+            parseErrors.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            parseChunk(p, lineEnd - p);
+        }
+        source.lineLength = 0;
+        p = lineEnd + 1;
+    }
+}
+
+#ifdef __linux__
+
+IngestionFrontend::IngestionFrontend(IngestionQueue &queue, int minSensorID, int maxSensorID, long long timestampToleranceMs)
+    : readingQueue(queue), minSensorID(minSensorID), maxSensorID(maxSensorID), timestampToleranceMs(timestampToleranceMs)
+{
+    refreshValidationClock();
+    pendingBatch.reserve(HANDOFF_BATCH_SIZE);
+    datagramBuffers.resize(RECV_BATCH_MESSAGES * DATAGRAM_BUFFER_BYTES);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || stopFd < 0)
+    {
+        std::cerr << "Error: Failed to create ingestion event loop: " << std::strerror(errno) << std::endl;
+        return;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event);
+}
+
+IngestionFrontend::~IngestionFrontend()
+{
+    for (std::unique_ptr<Source> &source : sources)
+    {
+        if (source->ownsFd)
+        {
+            close(source->fd);
+        }
+    }
+    if (stopFd >= 0)
+    {
+        close(stopFd);
+    }
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+    }
+}
+
+bool IngestionFrontend::registerSource(int fd, SourceType type, bool ownsFd)
+{
+    std::unique_ptr<Source> source(new Source());
+    source->fd = fd;
+    source->type = type;
+    source->ownsFd = ownsFd;
+    if (type == SourceType::Stream)
+    {
+        source->lineBuffer.resize(STREAM_LINE_BUFFER_BYTES);
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = source.get();
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        return false;
+    }
+    sources.push_back(std::move(source));
+    return true;
+}
+
+void IngestionFrontend::closeSource(Source *source)
+{
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, source->fd, nullptr);
+    if (source->ownsFd)
+    {
+        close(source->fd);
+    }
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        if (sources[i].get() == source)
+        {
+            sources[i] = std::move(sources.back());
+            sources.pop_back();
+            break;
+        }
+    }
+}
+
+bool IngestionFrontend::addUdpListener(int port)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        std::cerr << "Error: UDP socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int receiveBufferBytes = 8 * 1024 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBufferBytes, sizeof(receiveBufferBytes));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        !registerSource(fd, SourceType::Udp, true))
+    {
+        std::cerr << "Error: UDP port " << port << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+    return true;
+}
+
+bool IngestionFrontend::addUnixListener(const std::string &path)
+{
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Error: Unix socket path too long: " << path << std::endl;
+        return false;
+    }
+
+    // Only a stale socket may be replaced; any other existing file is left alone.
+    struct stat existing;
+    if (lstat(path.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            std::cerr << "Error: Unix socket " << path << ": path exists and is not a socket" << std::endl;
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        std::cerr << "Error: Unix socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0 ||
+        !registerSource(fd, SourceType::UnixListener, true))
+    {
+        std::cerr << "Error: Unix socket " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+    return true;
+}
+
+bool IngestionFrontend::addStdin()
+{
+    // stdin's file description is shared with the parent, so its flags are left untouched.
+    if (registerSource(STDIN_FILENO, SourceType::Stream, false))
+    {
+        return true;
+    }
+
+    // Regular files cannot be polled; they are read to EOF before the loop starts.
+    if (errno == EPERM)
+    {
+        regularFileFd = STDIN_FILENO;
+        return true;
+    }
+    std::cerr << "Error: stdin: " << std::strerror(errno) << std::endl;
+    return false;
+}
+
+void IngestionFrontend::drainRegularFile()
+{
+    Source source;
+    source.fd = regularFileFd;
+    source.ownsFd = false;
+    source.lineBuffer.resize(STREAM_LINE_BUFFER_BYTES);
+    while (running.load(std::memory_order_relaxed))
+    {
+        refreshValidationClock();
+        ssize_t bytesRead = read(regularFileFd, datagramBuffers.data(), datagramBuffers.size());
+        if (bytesRead <= 0)
+        {
+            break;
+        }
+        bytesReceived.fetch_add(bytesRead, std::memory_order_relaxed);
+        consumeStreamBytes(source, datagramBuffers.data(), bytesRead);
+    }
+    consumeStreamBytes(source, "\n", 1);
+    flushBatch();
+    regularFileFd = -1;
+}
+
+void IngestionFrontend::handleUdp(Source &source)
+{
+    mmsghdr messages[RECV_BATCH_MESSAGES];
+    iovec vectors[RECV_BATCH_MESSAGES];
+    for (size_t i = 0; i < RECV_BATCH_MESSAGES; ++i)
+    {
+        vectors[i].iov_base = datagramBuffers.data() + i * DATAGRAM_BUFFER_BYTES;
+        vectors[i].iov_len = DATAGRAM_BUFFER_BYTES;
+        std::memset(&messages[i].msg_hdr, 0, sizeof(messages[i].msg_hdr));
+        messages[i].msg_hdr.msg_iov = &vectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    for (int round = 0; round < MAX_RECV_ROUNDS_PER_EVENT; ++round)
+    {
+        int received = recvmmsg(source.fd, messages, RECV_BATCH_MESSAGES, MSG_DONTWAIT, nullptr);
+        if (received <= 0)
+        {
+            return;
+        }
+        datagramsReceived.fetch_add(received, std::memory_order_relaxed);
+        for (int i = 0; i < received; ++i)
+        {
+            bytesReceived.fetch_add(messages[i].msg_len, std::memory_order_relaxed);
+            if (messages[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                parseErrors.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            parseChunk(static_cast<const char *>(vectors[i].iov_base), messages[i].msg_len);
+        }
+        if (static_cast<size_t>(received) < RECV_BATCH_MESSAGES)
+        {
+            return;
+        }
+    }
+}
+
+void IngestionFrontend::handleListener(Source &source)
+{
+    while (true)
+    {
+        int connectionFd = accept4(source.fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (connectionFd < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return;
+            }
+            if (errno == EINTR || errno == ECONNABORTED || errno == EPROTO)
+            {
+                acceptRetries.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            // EMFILE, ENFILE, ENOBUFS, ENOMEM: the listener stays readable, so stop polling
+            // it for a while instead of spinning on a level-triggered event.
+            pauseListener(source);
+            return;
+        }
+        if (!registerSource(connectionFd, SourceType::Stream, true))
+        {
+            close(connectionFd);
+        }
+    }
+}
+
+void IngestionFrontend::pauseListener(Source &source)
+{
+    epoll_event event{};
+    event.events = 0;
+    event.data.ptr = &source;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, source.fd, &event);
+    source.paused = true;
+    acceptBackoffs.fetch_add(1, std::memory_order_relaxed);
+    if (!listenersPaused)
+    {
+        listenersPaused = true;
+        listenerResumeMs = steadyNowMs() + ACCEPT_BACKOFF_MS;
+    }
+}
+
+void IngestionFrontend::resumeListeners()
+{
+    for (std::unique_ptr<Source> &source : sources)
+    {
+        if (source->paused)
+        {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = source.get();
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, source->fd, &event);
+            source->paused = false;
+        }
+    }
+    listenersPaused = false;
+}
+
+int IngestionFrontend::nextWaitTimeoutMs() const
+{
+    if (!listenersPaused)
+    {
+        return -1;
+    }
+    return static_cast<int>(std::max(0LL, listenerResumeMs - steadyNowMs()));
+}
+
+// Returns false once the peer has closed the stream. Borrowed descriptors such as stdin
+// stay blocking, so they get a single read per readiness event.
+bool IngestionFrontend::handleStream(Source &source)
+{
+    int rounds = source.ownsFd ? MAX_RECV_ROUNDS_PER_EVENT : 1;
+    for (int round = 0; round < rounds; ++round)
+    {
+        size_t readBytes = std::min(STREAM_READ_BYTES, datagramBuffers.size());
+        ssize_t bytesRead = read(source.fd, datagramBuffers.data(), readBytes);
+        if (bytesRead == 0)
+        {
+            consumeStreamBytes(source, "\n", 1);
+            return false;
+        }
+        if (bytesRead < 0)
+        {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        bytesReceived.fetch_add(bytesRead, std::memory_order_relaxed);
+        consumeStreamBytes(source, datagramBuffers.data(), bytesRead);
+    }
+    return true;
+}
+
+void IngestionFrontend::run()
+{
+    if (epollFd < 0 || stopFd < 0)
+    {
+        return;
+    }
+    running.store(true, std::memory_order_relaxed);
+    if (regularFileFd >= 0)
+    {
+        drainRegularFile();
+    }
+
+    epoll_event events[MAX_EPOLL_EVENTS];
+    while (running.load(std::memory_order_relaxed))
+    {
+        int ready = epoll_wait(epollFd, events, MAX_EPOLL_EVENTS, nextWaitTimeoutMs());
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            std::cerr << "Error: epoll_wait: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        refreshValidationClock();
+        if (listenersPaused && steadyNowMs() >= listenerResumeMs)
+        {
+            resumeListeners();
+        }
+
+        for (int i = 0; i < ready; ++i)
+        {
+            Source *source = static_cast<Source *>(events[i].data.ptr);
+            if (source == nullptr)
+            {
+                running.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            switch (source->type)
+            {
+            case SourceType::Udp:
+                handleUdp(*source);
+                break;
+            case SourceType::UnixListener:
+                handleListener(*source);
+                break;
+            case SourceType::Stream:
+                if (!handleStream(*source))
+                {
+                    closeSource(source);
+                }
+                break;
+            }
+        }
+        flushBatch();
+    }
+    flushBatch();
+}
+
+void IngestionFrontend::stop()
+{
+    running.store(false, std::memory_order_relaxed);
+    if (stopFd >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t ignored = write(stopFd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+#else
+
+IngestionFrontend::IngestionFrontend(IngestionQueue &queue, int minSensorID, int maxSensorID, long long timestampToleranceMs)
+    : readingQueue(queue), minSensorID(minSensorID), maxSensorID(maxSensorID), timestampToleranceMs(timestampToleranceMs) {}
+IngestionFrontend::~IngestionFrontend() {}
+
+bool IngestionFrontend::addUdpListener(int)
+{
+    std::cerr << "Error: Network ingestion requires Linux." << std::endl;
+    return false;
+}
+
+bool IngestionFrontend::addUnixListener(const std::string &)
+{
+    std::cerr << "Error: Network ingestion requires Linux." << std::endl;
+    return false;
+}
+
+bool IngestionFrontend::addStdin()
+{
+    std::cerr << "Error: Network ingestion requires Linux." << std::endl;
+    return false;
+}
+
+void IngestionFrontend::run() {}
+void IngestionFrontend::stop() {}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef INGESTIONFRONTEND_HPP
+#define INGESTIONFRONTEND_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SensorReading.hpp"
+#include "IngestionQueue.hpp"
+
+// Parses one "sensorID,timestamp,temperature" line without allocating; non-finite temperatures are rejected.
+bool parseReadingLine(const char *begin, const char *end, SensorReading &reading);
+
+struct FrontendCounters
+{
+    unsigned long long readingsParsed = 0;
+    unsigned long long parseErrors = 0;
+    unsigned long long outOfRangeReadings = 0; // well-formed but sensor ID or timestamp out of bounds
+    unsigned long long datagramsReceived = 0;
+    unsigned long long bytesReceived = 0;
+    unsigned long long batchesHandedOff = 0;
+    unsigned long long acceptRetries = 0;  // interrupted or aborted connections
+    unsigned long long acceptBackoffs = 0; // listener paused after descriptor or memory exhaustion
+};
+
+// Single epoll loop receiving CSV readings from UDP (recvmmsg batches), Unix stream
+// sockets and stdin, handing them to the ingestion queue in batches. Linux only.
+class IngestionFrontend
+{
+private:
+    enum class SourceType
+    {
+        Udp,
+        UnixListener,
+        Stream
+    };
+
+    struct Source
+    {
+        int fd = -1;
+        SourceType type = SourceType::Stream;
+        bool ownsFd = true;
+        std::vector<char> lineBuffer;
+        size_t lineLength = 0;
+        bool discardingLine = false;
+        bool paused = false;
+    };
+
+    IngestionQueue &readingQueue;
+    int minSensorID;
+    int maxSensorID;
+    long long timestampToleranceMs;
+    long long validationNowMs = 0;
+    int epollFd = -1;
+    int stopFd = -1;
+    std::vector<std::unique_ptr<Source>> sources;
+    int regularFileFd = -1;
+    bool listenersPaused = false;
+    long long listenerResumeMs = 0;
+    std::vector<SensorReading> pendingBatch;
+    std::vector<char> datagramBuffers;
+    std::atomic<bool> running{false};
+
+    std::atomic<unsigned long long> readingsParsed{0};
+    std::atomic<unsigned long long> parseErrors{0};
+    std::atomic<unsigned long long> outOfRangeReadings{0};
+    std::atomic<unsigned long long> datagramsReceived{0};
+    std::atomic<unsigned long long> bytesReceived{0};
+    std::atomic<unsigned long long> batchesHandedOff{0};
+    std::atomic<unsigned long long> acceptRetries{0};
+    std::atomic<unsigned long long> acceptBackoffs{0};
+
+    bool registerSource(int fd, SourceType type, bool ownsFd);
+    void closeSource(Source *source);
+    void refreshValidationClock();
+    bool isAcceptable(const SensorReading &reading) const;
+    void parseChunk(const char *data, size_t length);
+    void consumeStreamBytes(Source &source, const char *data, size_t length);
+    void handleUdp(Source &source);
+    void handleListener(Source &source);
+    void pauseListener(Source &source);
+    void resumeListeners();
+    int nextWaitTimeoutMs() const;
+    bool handleStream(Source &source);
+    void drainRegularFile();
+    void appendReading(const SensorReading &reading);
+    void flushBatch();
+
+public:
+    // Readings are only handed off when minSensorID <= sensorID <= maxSensorID and the
+    // timestamp is within timestampToleranceMs of the current wall clock.
+    IngestionFrontend(IngestionQueue &queue, int minSensorID, int maxSensorID, long long timestampToleranceMs);
+    ~IngestionFrontend();
+    IngestionFrontend(const IngestionFrontend &) = delete;
+    IngestionFrontend &operator=(const IngestionFrontend &) = delete;
+
+    bool addUdpListener(int port);
+    bool addUnixListener(const std::string &path);
+    bool addStdin();
+    void run();
+    void stop();
+    FrontendCounters getCounters() const;
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include "IngestionQueue.hpp"
+#include <chrono>
+
+IngestionQueue::IngestionQueue(size_t capacity, size_t overflowAllowance, OverflowPolicy policy, bool coalesceUnderPressure,
+                               double normalLow, double normalHigh)
+    : capacity(capacity == 0 ? 1 : capacity), overflowAllowance(overflowAllowance), policy(policy),
+      coalesceUnderPressure(coalesceUnderPressure), normalLow(normalLow), normalHigh(normalHigh) {}
+
+bool IngestionQueue::isNormalReading(const SensorReading &reading) const
+{
+    return reading.temperature >= normalLow && reading.temperature <= normalHigh;
+}
+
+size_t IngestionQueue::bufferedCount() const
+{
+    return normalReadings.size() + outOfBandReadings.size();
+}
+
+// Replaces the newest queued normal reading of the same sensor, so under pressure each
+// sensor holds at most its latest normal value. Queued out-of-band readings are never replaced.
+bool IngestionQueue::coalesceIntoQueued(const SensorReading &reading)
+{
+    if (!isNormalReading(reading))
+    {
+        return false;
+    }
+
+    auto found = newestNormalBySensor.find(reading.sensorID);
+    if (found == newestNormalBySensor.end())
+    {
+        return false;
+    }
+    normalReadings[found->second - normalFrontSequence].reading = reading;
+    counters.coalesced++;
+    return true;
+}
+
+void IngestionQueue::appendReading(const SensorReading &reading)
+{
+    if (isNormalReading(reading))
+    {
+        newestNormalBySensor[reading.sensorID] = normalFrontSequence + normalReadings.size();
+        normalReadings.push_back(QueuedReading{reading, nextArrival++});
+    }
+    else
+    {
+        // A later normal reading must not coalesce into one queued ahead of this reading.
+        newestNormalBySensor.erase(reading.sensorID);
+        outOfBandReadings.push_back(QueuedReading{reading, nextArrival++});
+    }
+}
+
+void IngestionQueue::popOldestNormal()
+{
+    auto found = newestNormalBySensor.find(normalReadings.front().reading.sensorID);
+    if (found != newestNormalBySensor.end() && found->second == normalFrontSequence)
+    {
+        newestNormalBySensor.erase(found);
+    }
+    normalReadings.pop_front();
+    normalFrontSequence++;
+}
+
+SensorReading IngestionQueue::popOldest()
+{
+    if (outOfBandReadings.empty() ||
+        (!normalReadings.empty() && normalReadings.front().arrival < outOfBandReadings.front().arrival))
+    {
+        SensorReading reading = normalReadings.front().reading;
+        popOldestNormal();
+        return reading;
+    }
+    SensorReading reading = outOfBandReadings.front().reading;
+    outOfBandReadings.pop_front();
+    return reading;
+}
+
+void IngestionQueue::pushLocked(const SensorReading &reading, std::unique_lock<std::mutex> &lock)
+{
+    if (bufferedCount() >= capacity)
+    {
+        if (coalesceUnderPressure && coalesceIntoQueued(reading))
+        {
+            return;
+        }
+
+        switch (policy)
+        {
+        case OverflowPolicy::BlockProducer:
+            counters.blockedPushes++;
+            notFull.wait(lock, [this]
+                         { return bufferedCount() < capacity; });
+            break;
+        case OverflowPolicy::DropOldest:
+            popOldest();
+            counters.droppedOldest++;
+            break;
+        case OverflowPolicy::ShedNormalFirst:
+            if (isNormalReading(reading))
+            {
+                counters.shedNormalIncoming++;
+                return;
+            }
+            if (!normalReadings.empty())
+            {
+                popOldestNormal();
+                counters.shedNormalQueued++;
+            }
+            else if (bufferedCount() < capacity + overflowAllowance)
+            {
+                counters.admittedOverCapacity++;
+            }
+            else
+            {
+                outOfBandReadings.pop_front();
+                counters.droppedOutOfBand++;
+            }
+            break;
+        }
+    }
+
+    appendReading(reading);
+    counters.accepted++;
+    if (bufferedCount() > counters.highWaterMark)
+    {
+        counters.highWaterMark = bufferedCount();
+    }
+}
+
+void IngestionQueue::push(const SensorReading &reading)
+{
+    {
+        std::unique_lock<std::mutex> lock(bufferMutex);
+        pushLocked(reading, lock);
+    }
+    notEmpty.notify_one();
+}
+
+void IngestionQueue::pushBatch(const SensorReading *readings, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(bufferMutex);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (policy == OverflowPolicy::BlockProducer && bufferedCount() >= capacity)
+            {
+                notEmpty.notify_one();
+            }
+            pushLocked(readings[i], lock);
+        }
+    }
+    notEmpty.notify_one();
+}
+
+size_t IngestionQueue::popBatch(std::vector<SensorReading> &out, size_t maxCount)
+{
+    size_t popped = 0;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        while (bufferedCount() > 0 && popped < maxCount)
+        {
+            out.push_back(popOldest());
+            popped++;
+        }
+        counters.delivered += popped;
+    }
+    if (popped > 0)
+    {
+        notFull.notify_all();
+    }
+    return popped;
+}
+
+size_t IngestionQueue::waitPopBatch(std::vector<SensorReading> &out, size_t maxCount, int timeoutMs)
+{
+    {
+        std::unique_lock<std::mutex> lock(bufferMutex);
+        notEmpty.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]
+                          { return bufferedCount() > 0; });
+    }
+    return popBatch(out, maxCount);
+}
+
+IngestionCounters IngestionQueue::getCounters() const
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    return counters;
+}
+
+size_t IngestionQueue::size() const
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    return bufferedCount();
+}
@@ -0,0 +1,80 @@
+#ifndef INGESTIONQUEUE_HPP
+#define INGESTIONQUEUE_HPP
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <condition_variable>
+#include <vector>
+#include "SensorReading.hpp"
+
+enum class OverflowPolicy
+{
+    BlockProducer,  // producer waits until the monitor frees a slot
+    DropOldest,     // oldest queued reading is discarded to make room
+    ShedNormalFirst // normal-band readings are shed first; out-of-band readings may use the overflow allowance
+};
+
+struct IngestionCounters
+{
+    unsigned long long accepted = 0;
+    unsigned long long delivered = 0;
+    unsigned long long blockedPushes = 0;
+    unsigned long long droppedOldest = 0;
+    unsigned long long shedNormalIncoming = 0;
+    unsigned long long shedNormalQueued = 0;
+    unsigned long long coalesced = 0;
+    unsigned long long admittedOverCapacity = 0;
+    unsigned long long droppedOutOfBand = 0;
+    size_t highWaterMark = 0;
+};
+
+class IngestionQueue
+{
+private:
+    struct QueuedReading
+    {
+        SensorReading reading;
+        unsigned long long arrival;
+    };
+
+    // Normal and out-of-band readings are kept in separate FIFOs so the oldest normal
+    // reading can be shed in O(1); pops merge the two fronts by arrival order.
+    std::deque<QueuedReading> normalReadings;
+    std::deque<QueuedReading> outOfBandReadings;
+    unsigned long long normalFrontSequence = 0;
+    unsigned long long nextArrival = 0;
+    std::unordered_map<int, unsigned long long> newestNormalBySensor;
+    mutable std::mutex bufferMutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    IngestionCounters counters;
+
+    size_t capacity;
+    size_t overflowAllowance;
+    OverflowPolicy policy;
+    bool coalesceUnderPressure;
+    double normalLow;
+    double normalHigh;
+
+    bool isNormalReading(const SensorReading &reading) const;
+    size_t bufferedCount() const;
+    bool coalesceIntoQueued(const SensorReading &reading);
+    void appendReading(const SensorReading &reading);
+    void popOldestNormal();
+    SensorReading popOldest();
+    void pushLocked(const SensorReading &reading, std::unique_lock<std::mutex> &lock);
+
+public:
+    IngestionQueue(size_t capacity, size_t overflowAllowance, OverflowPolicy policy, bool coalesceUnderPressure,
+                   double normalLow, double normalHigh);
+    void push(const SensorReading &reading);
+    void pushBatch(const SensorReading *readings, size_t count);
+    size_t popBatch(std::vector<SensorReading> &out, size_t maxCount);
+    size_t waitPopBatch(std::vector<SensorReading> &out, size_t maxCount, int timeoutMs);
+    IngestionCounters getCounters() const;
+    size_t size() const;
+};
+
+#endif
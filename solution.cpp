@@ -12,6 +12,7 @@ using namespace chrono;
 
 std::vector<SensorReading> allReadings;
 std::vector<int> readingPositionsInHeap;
+std::vector<int> freeReadingSlots; // expired allReadings slots available for reuse
 std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>,
                     std::greater<std::pair<long long, int>>>
     expirationQueue;
@@ -29,6 +30,9 @@ const int ANOMALY_CHECK_K = 5;
 const double HIGH_TEMP_THRESHOLD = 48.0;
 const int MAX_SENSOR_ID = 15;
 const int MIN_SENSOR_ID = 1;
+const long long HISTORY_RETENTION_MS = 6LL * 60 * 60 * 1000;
+const int HISTORY_MANTISSA_BITS = 52; // 52 keeps temperatures lossless; fewer bits trade precision for size
+HistoryStore readingHistory(HISTORY_RETENTION_MS, HISTORY_MANTISSA_BITS);
 
 void processReading(const SensorReading &reading)
 {
@@ -44,13 +48,25 @@ void processReading(const SensorReading &reading)
             int heapIndexToRemove = readingPositionsInHeap[expiredReadingIndex];
             double expiredTemp = allReadings[expiredReadingIndex].temperature;
             minMaxHeap.deleteElementAtHeapIndex(heapIndexToRemove);
+            readingHistory.append(allReadings[expiredReadingIndex]);
             activeTemperatureSum -= expiredTemp;
             activeReadingCounter--;
+            freeReadingSlots.push_back(expiredReadingIndex);
         }
     }
 
-    allReadings.push_back(reading);
-    int newReadingIndex = allReadings.size() - 1;
+    int newReadingIndex;
+    if (!freeReadingSlots.empty())
+    {
+        newReadingIndex = freeReadingSlots.back();
+        freeReadingSlots.pop_back();
+        allReadings[newReadingIndex] = reading;
+    }
+    else
+    {
+        allReadings.push_back(reading);
+        newReadingIndex = allReadings.size() - 1;
+    }
 
     if (newReadingIndex >= readingPositionsInHeap.size())
     {
@@ -7,9 +7,11 @@
 #include <utility>
 #include "SensorReading.hpp"
 #include "MinMaxHeap.hpp"
+#include "HistoryStore.hpp"
 
 extern std::vector<SensorReading> allReadings;
 extern std::vector<int> readingPositionsInHeap;
+extern std::vector<int> freeReadingSlots;
 extern std::priority_queue<
     std::pair<long long, int>,
     std::vector<std::pair<long long, int>>,
@@ -22,6 +24,7 @@ extern std::vector<long long> latestSensorTimestamps;
 extern std::vector<long long> sensorEntryTimestamps;
 extern std::ofstream alertLogFile;
 extern MinMaxHeap minMaxHeap;
+extern HistoryStore readingHistory;
 
 extern const int MAX_SENSORS_PLUS_ONE;
 extern const long long READING_EXPIRATION_MS;
@@ -29,6 +32,8 @@ extern const int ANOMALY_CHECK_K;
 extern const double HIGH_TEMP_THRESHOLD;
 extern const int MAX_SENSOR_ID;
 extern const int MIN_SENSOR_ID;
+extern const long long HISTORY_RETENTION_MS;
+extern const int HISTORY_MANTISSA_BITS;
 
 void processReading(const SensorReading &reading);
 
@@ -1,13 +1,15 @@
 #include <iostream>
 #include <thread>
-#include <mutex>
-#include <queue>
 #include <random>
 #include <chrono>
+#include <charconv>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "SensorReading.hpp"
 #include "solution.hpp"
+#include "IngestionQueue.hpp"
+#include "IngestionFrontend.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -18,10 +20,22 @@ const int delayMs = 100;     // Interval between readings per sensor
 const int anomalyEvery = 15; // Inject anomalies every 15 readings
 const int seed = 42;         // GLOBAL SEED for reproducibility
 
-// Shared queue and mutex
-queue<SensorReading> readingQueue;
-mutex queueMutex;
+// Ingestion configuration
+const size_t queueCapacity = 1024;
+const size_t queueOverflowAllowance = 256; // Extra slots reserved for out-of-band readings
+const OverflowPolicy overflowPolicy = OverflowPolicy::ShedNormalFirst;
+const bool coalescePerSensor = true;
+const double normalBandLow = 30.0; // Readings outside [low, HIGH_TEMP_THRESHOLD] are never shed
+const size_t monitorBatchSize = 64;
+const long long countersReportIntervalMs = 10000;
 
+// Shared bounded queue
+IngestionQueue readingQueue(queueCapacity, queueOverflowAllowance, overflowPolicy, coalescePerSensor, normalBandLow, HIGH_TEMP_THRESHOLD);
+
+// External reading sources (--udp PORT, --unix PATH, --stdin); the simulator runs when none are given
+// Network readings must carry a known sensor ID and a timestamp within the history retention of now
+IngestionFrontend ingestionFrontend(readingQueue, 0, MAX_SENSORS_PLUS_ONE - 1, HISTORY_RETENTION_MS);
+bool frontendEnabled = false;
 // Random engines and distributions
 default_random_engine globalGen(seed);
 uniform_real_distribution<float> normalDist(40.0, 45.0);
@@ -60,41 +74,140 @@ void sensorStream(int sensorID)
         }
 
         // Push to queue
-        {
-            lock_guard<mutex> lock(queueMutex);
-            readingQueue.push(reading);
-        }
+        readingQueue.push(reading);
 
         this_thread::sleep_for(milliseconds(delayMs));
         count++;
     }
 }
 
+// Print ingestion counters
+void reportIngestionCounters()
+{
+    IngestionCounters c = readingQueue.getCounters();
+    cout << "[INGEST] queued: " << readingQueue.size()
+         << " | accepted: " << c.accepted
+         << " | delivered: " << c.delivered
+         << " | blocked: " << c.blockedPushes
+         << " | dropped oldest: " << c.droppedOldest
+         << " | shed normal (incoming): " << c.shedNormalIncoming
+         << " | shed normal (queued): " << c.shedNormalQueued
+         << " | coalesced: " << c.coalesced
+         << " | over capacity: " << c.admittedOverCapacity
+         << " | dropped out-of-band: " << c.droppedOutOfBand
+         << " | high water: " << c.highWaterMark << endl;
+
+    if (frontendEnabled)
+    {
+        FrontendCounters f = ingestionFrontend.getCounters();
+        cout << "[FRONTEND] parsed: " << f.readingsParsed
+             << " | parse errors: " << f.parseErrors
+             << " | out of range: " << f.outOfRangeReadings
+             << " | datagrams: " << f.datagramsReceived
+             << " | bytes: " << f.bytesReceived
+             << " | batches: " << f.batchesHandedOff
+             << " | accept retries: " << f.acceptRetries
+             << " | accept backoffs: " << f.acceptBackoffs << endl;
+    }
+
+    HistoryStats h = readingHistory.getStats();
+    cout << "[HISTORY] sensors: " << h.sensors
+         << " | readings: " << h.readings
+         << " | blocks: " << h.blocks
+         << " | payload bytes: " << h.payloadBytes
+         << " | allocated bytes: " << h.allocatedBytes
+         << " | payload bytes/reading: " << (h.readings > 0 ? static_cast<double>(h.payloadBytes) / h.readings : 0.0)
+         << " | allocated bytes/reading: " << (h.readings > 0 ? static_cast<double>(h.allocatedBytes) / h.readings : 0.0)
+         << " | evicted blocks: " << h.evictedBlocks << endl;
+}
+
 // Monitor thread
 void monitorReadings()
 {
+    vector<SensorReading> batch;
+    batch.reserve(monitorBatchSize);
+    long long lastReportMs = currentTimestamp();
     while (true)
     {
-        SensorReading reading;
+        batch.clear();
+        readingQueue.waitPopBatch(batch, monitorBatchSize, 50);
+        for (const SensorReading &reading : batch)
         {
-            lock_guard<mutex> lock(queueMutex);
-            if (!readingQueue.empty())
-            {
-                reading = readingQueue.front();
-                readingQueue.pop();
-                processReading(reading); // Call the function from solution.cpp
-            }
+            processReading(reading); // Call the function from solution.cpp
+        }
+
+        long long nowMs = currentTimestamp();
+        if (nowMs - lastReportMs >= countersReportIntervalMs)
+        {
+            reportIngestionCounters();
+            lastReportMs = nowMs;
         }
-        this_thread::sleep_for(milliseconds(50));
     }
 }
 
-int main()
+// Parse a UDP port in 1..65535
+bool parsePort(const char *text, int &port)
 {
-    // Start sensor threads
-    for (int i = 1; i <= numSensors; ++i)
+    const char *end = text + strlen(text);
+    from_chars_result result = from_chars(text, end, port);
+    return result.ec == errc() && result.ptr == end && port >= 1 && port <= 65535;
+}
+
+void printUsage(const char *program)
+{
+    cerr << "Usage: " << program << " [--udp PORT] [--unix PATH] [--stdin]" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    // Register external sources
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool added = false;
+        if (arg == "--udp" && i + 1 < argc)
+        {
+            int port = 0;
+            if (!parsePort(argv[++i], port))
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+            added = ingestionFrontend.addUdpListener(port);
+        }
+        else if (arg == "--unix" && i + 1 < argc)
+        {
+            added = ingestionFrontend.addUnixListener(argv[++i]);
+        }
+        else if (arg == "--stdin")
+        {
+            added = ingestionFrontend.addStdin();
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!added)
+        {
+            return 1;
+        }
+        frontendEnabled = true;
+    }
+
+    if (frontendEnabled)
+    {
+        thread([]
+               { ingestionFrontend.run(); })
+            .detach();
+    }
+    else
     {
-        thread(sensorStream, i).detach();
+        // Start sensor threads
+        for (int i = 1; i <= numSensors; ++i)
+        {
+            thread(sensorStream, i).detach();
+        }
     }
 
     // Start monitor thread
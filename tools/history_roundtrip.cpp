@@ -0,0 +1,248 @@
+// Round-trip check for the HistoryStore codec.
+// Build: g++ -std=c++17 -O2 -I. -o history_roundtrip tools/history_roundtrip.cpp HistoryStore.cpp
+// Usage: history_roundtrip (exit status is non-zero on failure)
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+#include "HistoryStore.hpp"
+
+using namespace std;
+
+const int seed = 42;
+const int64_t baseTimestamp = 1700000000000LL;
+const int64_t unlimitedRetentionMs = numeric_limits<int64_t>::max() / 2;
+
+int failures = 0;
+
+void check(bool condition, const string &message)
+{
+    if (!condition)
+    {
+        cerr << "FAIL: " << message << endl;
+        failures++;
+    }
+}
+
+bool sameBits(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Readings with jitter, out-of-order timestamps, large gaps, repeats and non-finite values.
+vector<SensorReading> makeReadings(int sensorID, int count, default_random_engine &gen)
+{
+    uniform_real_distribution<float> normalDist(40.0, 45.0);
+    uniform_real_distribution<double> wideDist(-1000.0, 1000.0);
+    uniform_int_distribution<int> jitter(-3, 3);
+    uniform_int_distribution<int> pick(0, 99);
+
+    vector<SensorReading> readings;
+    int64_t timestamp = baseTimestamp;
+    double temperature = 42.0;
+    for (int i = 0; i < count; ++i)
+    {
+        int p = pick(gen);
+        timestamp += 100 + jitter(gen);
+        if (p == 0)
+            timestamp -= 5000; // out of order
+        else if (p == 1)
+            timestamp += 10000000000LL; // large gap, needs the 64-bit bucket
+
+        if (p < 60)
+            temperature = normalDist(gen);
+        else if (p < 80)
+            temperature = wideDist(gen);
+        else if (p == 97)
+            temperature = numeric_limits<double>::quiet_NaN();
+        else if (p == 98)
+            temperature = numeric_limits<double>::infinity();
+        // otherwise repeat the previous value
+
+        readings.push_back(SensorReading{sensorID, timestamp, temperature});
+    }
+    return readings;
+}
+
+void checkRoundTrip()
+{
+    default_random_engine gen(seed);
+    HistoryStore store(unlimitedRetentionMs);
+    map<int, vector<SensorReading>> expected;
+    for (int sensorID = 1; sensorID <= 5; ++sensorID)
+    {
+        expected[sensorID] = makeReadings(sensorID, 20000, gen);
+    }
+
+    // Interleave sensors the way the expiry path does.
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        for (auto &entry : expected)
+        {
+            store.append(entry.second[i]);
+        }
+    }
+
+    for (auto &entry : expected)
+    {
+        vector<SensorReading> decoded;
+        store.scanRange(entry.first, numeric_limits<int64_t>::min(), numeric_limits<int64_t>::max(), decoded);
+        check(decoded.size() == entry.second.size(), "full scan size for sensor " + to_string(entry.first));
+        for (size_t i = 0; i < decoded.size() && i < entry.second.size(); ++i)
+        {
+            if (decoded[i].sensorID != entry.first ||
+                decoded[i].timestamp != entry.second[i].timestamp ||
+                !sameBits(decoded[i].temperature, entry.second[i].temperature))
+            {
+                check(false, "round trip mismatch for sensor " + to_string(entry.first) + " at " + to_string(i));
+                break;
+            }
+        }
+
+        int64_t from = entry.second[5000].timestamp;
+        int64_t to = entry.second[6000].timestamp;
+        size_t naiveCount = 0;
+        for (const SensorReading &r : entry.second)
+        {
+            if (r.timestamp >= from && r.timestamp <= to)
+                naiveCount++;
+        }
+        vector<SensorReading> ranged;
+        store.scanRange(entry.first, from, to, ranged);
+        check(ranged.size() == naiveCount, "range scan size for sensor " + to_string(entry.first));
+    }
+
+    HistoryStats stats = store.getStats();
+    check(stats.readings == 5 * 20000ULL, "stats reading count");
+    check(stats.blocks > 5, "readings span several blocks per sensor");
+    check(stats.allocatedBytes >= stats.payloadBytes, "allocated bytes cover payload");
+}
+
+void checkDownsample()
+{
+    default_random_engine gen(seed + 1);
+    uniform_real_distribution<float> normalDist(40.0, 45.0);
+    HistoryStore store(unlimitedRetentionMs);
+
+    struct Expected
+    {
+        int count = 0;
+        double minTemperature = 0.0;
+        double maxTemperature = 0.0;
+        double sum = 0.0;
+    };
+    const int64_t bucketMs = 60000;
+    const int64_t from = baseTimestamp + 30000;
+    const int64_t to = baseTimestamp + 3600000;
+    map<int64_t, Expected> expected;
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        SensorReading reading{7, baseTimestamp + i * 100LL, normalDist(gen)};
+        store.append(reading);
+        if (reading.timestamp < from || reading.timestamp > to)
+            continue;
+        int64_t bucketStart = from + (reading.timestamp - from) / bucketMs * bucketMs;
+        Expected &e = expected[bucketStart];
+        if (e.count == 0)
+            e.minTemperature = e.maxTemperature = reading.temperature;
+        e.count++;
+        e.minTemperature = min(e.minTemperature, reading.temperature);
+        e.maxTemperature = max(e.maxTemperature, reading.temperature);
+        e.sum += reading.temperature;
+    }
+
+    vector<HistoryBucket> buckets = store.downsample(7, from, to, bucketMs);
+    check(buckets.size() == expected.size(), "downsample bucket count");
+    for (const HistoryBucket &bucket : buckets)
+    {
+        auto found = expected.find(bucket.bucketStart);
+        if (found == expected.end())
+        {
+            check(false, "unexpected bucket " + to_string(bucket.bucketStart));
+            continue;
+        }
+        const Expected &e = found->second;
+        check(bucket.count == e.count &&
+                  bucket.minTemperature == e.minTemperature &&
+                  bucket.maxTemperature == e.maxTemperature &&
+                  fabs(bucket.meanTemperature - e.sum / e.count) < 1e-9,
+              "bucket contents at " + to_string(bucket.bucketStart));
+    }
+    check(store.downsample(99, from, to, bucketMs).empty(), "unknown sensor yields no buckets");
+}
+
+void checkRetentionAndMantissa()
+{
+    HistoryStore store(3600000, 12);
+    for (int i = 0; i < 200000; ++i)
+    {
+        store.append(SensorReading{1, baseTimestamp + i * 100LL, 40.0 + (i % 100) * 0.0137});
+    }
+    HistoryStats stats = store.getStats();
+    check(stats.evictedBlocks > 0, "old blocks are evicted");
+
+    vector<SensorReading> decoded;
+    store.scanRange(1, numeric_limits<int64_t>::min(), numeric_limits<int64_t>::max(), decoded);
+    check(!decoded.empty() && decoded.front().timestamp >= baseTimestamp + 200000 * 100LL - 2 * 3600000,
+          "retained history starts within the retention period");
+    for (const SensorReading &r : decoded)
+    {
+        int64_t i = (r.timestamp - baseTimestamp) / 100;
+        double original = 40.0 + (i % 100) * 0.0137;
+        // 12 mantissa bits at 32..64 C give a resolution of 2^5 / 2^12.
+        if (fabs(r.temperature - original) > 32.0 / 4096.0)
+        {
+            check(false, "truncated mantissa within resolution");
+            break;
+        }
+    }
+}
+
+// Sensors that stop reporting must be evicted even though only one sensor keeps appending.
+void checkEvictionAcrossSensors()
+{
+    const int64_t retentionMs = 3600000;
+    HistoryStore store(retentionMs);
+    int64_t timestamp = baseTimestamp;
+    for (int i = 0; i < 36000; ++i, timestamp += 100)
+    {
+        store.append(SensorReading{1 + i % 1000, timestamp, 42.0 + (i % 7)});
+    }
+    check(store.getStats().sensors == 1000, "all sensors tracked before eviction");
+
+    for (int i = 0; i < 3 * 36000; ++i, timestamp += 100)
+    {
+        store.append(SensorReading{1, timestamp, 42.0 + (i % 7)});
+    }
+
+    HistoryStats stats = store.getStats();
+    check(stats.sensors == 1, "silent sensors are evicted: " + to_string(stats.sensors) + " left");
+
+    vector<SensorReading> decoded;
+    store.scanRange(1, numeric_limits<int64_t>::min(), numeric_limits<int64_t>::max(), decoded);
+    int64_t cutoff = timestamp - 100 - retentionMs;
+    check(!decoded.empty() && decoded.back().timestamp == timestamp - 100, "newest reading retained");
+    check(!decoded.empty() && decoded.front().timestamp >= cutoff - 2 * 100 * static_cast<int64_t>(HistoryStore::BLOCK_BYTES),
+          "retained history starts near the cutoff");
+}
+
+int main()
+{
+    checkRoundTrip();
+    checkDownsample();
+    checkRetentionAndMantissa();
+    checkEvictionAcrossSensors();
+
+    if (failures > 0)
+    {
+        cout << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "All history checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,209 @@
+// Local load generator for the ingestion front end.
+// Build: g++ -std=c++17 -O2 -o ingest_sender tools/ingest_sender.cpp
+// Usage: ingest_sender [--udp PORT | --unix PATH] [--count N] [--sensors S] [--per-datagram K]
+#include <iostream>
+#include <chrono>
+#include <charconv>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace std;
+using namespace chrono;
+
+const int seed = 42;
+const size_t DATAGRAM_BYTES = 1400;
+const size_t SEND_BATCH_MESSAGES = 64;
+const int SEND_BACKOFF_US = 200;
+
+// Parse a whole argument as an integer in [minValue, maxValue]
+template <typename T>
+bool parseBounded(const char *text, T minValue, T maxValue, T &value)
+{
+    const char *end = text + strlen(text);
+    from_chars_result result = from_chars(text, end, value);
+    return result.ec == errc() && result.ptr == end && value >= minValue && value <= maxValue;
+}
+
+void printUsage(const char *program)
+{
+    cerr << "Usage: " << program << " [--udp PORT | --unix PATH] [--count N] [--sensors S] [--per-datagram K]" << endl;
+}
+
+long long currentTimestamp()
+{
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// Appends "sensorID,timestamp,temperature\n" and returns the new end, or nullptr if it does not fit.
+char *appendLine(char *p, char *end, int sensorID, long long timestamp, double temperature)
+{
+    to_chars_result r = to_chars(p, end, sensorID);
+    if (r.ec != errc() || r.ptr == end)
+        return nullptr;
+    *r.ptr++ = ',';
+    r = to_chars(r.ptr, end, timestamp);
+    if (r.ec != errc() || r.ptr == end)
+        return nullptr;
+    *r.ptr++ = ',';
+    r = to_chars(r.ptr, end, temperature, chars_format::fixed, 2);
+    if (r.ec != errc() || r.ptr == end)
+        return nullptr;
+    *r.ptr++ = '\n';
+    return r.ptr;
+}
+
+int main(int argc, char *argv[])
+{
+    int udpPort = 9000;
+    string unixPath;
+    long long count = 5000000;
+    int numSensors = 15;
+    int perDatagram = 40;
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        bool valid = true;
+        if (arg == "--udp")
+            valid = parseBounded(argv[i + 1], 1, 65535, udpPort);
+        else if (arg == "--unix")
+            unixPath = argv[i + 1];
+        else if (arg == "--count")
+            valid = parseBounded(argv[i + 1], 1LL, 1000000000000LL, count);
+        else if (arg == "--sensors")
+            valid = parseBounded(argv[i + 1], 1, 1000000, numSensors);
+        else if (arg == "--per-datagram")
+            valid = parseBounded(argv[i + 1], 1, 1000, perDatagram);
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int fd;
+    if (unixPath.empty())
+    {
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(udpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            cerr << "Error: UDP connect: " << strerror(errno) << endl;
+            return 1;
+        }
+    }
+    else
+    {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            cerr << "Error: Unix connect: " << strerror(errno) << endl;
+            return 1;
+        }
+    }
+
+    default_random_engine gen(seed);
+    uniform_real_distribution<double> normalDist(40.0, 45.0);
+    uniform_real_distribution<double> spikeDist(75.0, 85.0);
+
+    vector<char> buffers(SEND_BATCH_MESSAGES * DATAGRAM_BYTES);
+    vector<mmsghdr> messages(SEND_BATCH_MESSAGES);
+    vector<iovec> vectors(SEND_BATCH_MESSAGES);
+
+    long long sent = 0;
+    steady_clock::time_point start = steady_clock::now();
+    while (sent < count)
+    {
+        size_t messageCount = 0;
+        long long timestamp = currentTimestamp();
+        while (messageCount < SEND_BATCH_MESSAGES && sent < count)
+        {
+            char *begin = buffers.data() + messageCount * DATAGRAM_BYTES;
+            char *p = begin;
+            for (int line = 0; line < perDatagram && sent < count; ++line)
+            {
+                int sensorID = static_cast<int>(sent % numSensors) + 1;
+                double temperature = (sent % 1000 == 0) ? spikeDist(gen) : normalDist(gen);
+                char *next = appendLine(p, begin + DATAGRAM_BYTES, sensorID, timestamp, temperature);
+                if (next == nullptr)
+                    break;
+                p = next;
+                sent++;
+            }
+            vectors[messageCount].iov_base = begin;
+            vectors[messageCount].iov_len = p - begin;
+            memset(&messages[messageCount].msg_hdr, 0, sizeof(messages[messageCount].msg_hdr));
+            messages[messageCount].msg_hdr.msg_iov = &vectors[messageCount];
+            messages[messageCount].msg_hdr.msg_iovlen = 1;
+            messageCount++;
+        }
+
+        if (unixPath.empty())
+        {
+            size_t done = 0;
+            while (done < messageCount)
+            {
+                int n = sendmmsg(fd, messages.data() + done, messageCount - done, 0);
+                if (n < 0)
+                {
+                    if (errno == ENOBUFS || errno == EAGAIN)
+                    {
+                        this_thread::sleep_for(microseconds(SEND_BACKOFF_US));
+                        continue;
+                    }
+                    cerr << "Error: sendmmsg: " << strerror(errno) << endl;
+                    return 1;
+                }
+                done += n;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < messageCount; ++i)
+            {
+                const char *p = static_cast<const char *>(vectors[i].iov_base);
+                size_t remaining = vectors[i].iov_len;
+                while (remaining > 0)
+                {
+                    ssize_t n = write(fd, p, remaining);
+                    if (n < 0)
+                    {
+                        cerr << "Error: write: " << strerror(errno) << endl;
+                        return 1;
+                    }
+                    p += n;
+                    remaining -= n;
+                }
+            }
+        }
+    }
+
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    cout << "Sent " << sent << " readings in " << seconds << " s ("
+         << static_cast<long long>(sent / seconds) << " readings/s)" << endl;
+    close(fd);
+    return 0;
+}
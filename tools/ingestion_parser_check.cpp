@@ -0,0 +1,208 @@
+// Check for the ingestion front end's CSV parser and stream line reassembly.
+// Build: g++ -std=c++17 -O2 -pthread -I. -o ingestion_parser_check tools/ingestion_parser_check.cpp IngestionFrontend.cpp IngestionQueue.cpp
+// Usage: ingestion_parser_check (exit status is non-zero on failure)
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "IngestionFrontend.hpp"
+#include "IngestionQueue.hpp"
+
+using namespace std;
+using namespace chrono;
+
+int failures = 0;
+
+void check(bool condition, const string &message)
+{
+    if (!condition)
+    {
+        cerr << "FAIL: " << message << endl;
+        failures++;
+    }
+}
+
+long long currentTimestamp()
+{
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+bool parses(const string &line, SensorReading &reading)
+{
+    return parseReadingLine(line.data(), line.data() + line.size(), reading);
+}
+
+void checkParser()
+{
+    SensorReading r{};
+    check(parses("3,1700000000000,41.25", r) && r.sensorID == 3 && r.timestamp == 1700000000000LL && r.temperature == 41.25,
+          "plain line");
+    check(parses("3,1700000000000,41.25\r", r) && r.temperature == 41.25, "CRLF line");
+    check(parses("  3 ,\t1700000000000 , 41.25  ", r) && r.sensorID == 3 && r.temperature == 41.25, "surrounding spaces");
+    check(parses("3,1700000000000,-12.5", r) && r.temperature == -12.5, "negative temperature");
+    check(parses("3,1700000000000,1e1", r) && r.temperature == 10.0, "exponent temperature");
+
+    const char *rejected[] = {
+        "3,1700000000000,nan",
+        "3,1700000000000,inf",
+        "3,1700000000000,-inf",
+        "3,1700000000000,NAN",
+        "3,1700000000000,1e999",
+        "",
+        "3,1700000000000",
+        "3,1700000000000,41.25,7",
+        "x,1700000000000,41.25",
+        "3,,41.25",
+        "3,1700000000000,41.25x",
+        "99999999999,1700000000000,41.25",
+    };
+    for (const char *line : rejected)
+    {
+        check(!parses(line, r), string("rejects \"") + line + "\"");
+    }
+}
+
+int connectUnix(const string &path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Writes each piece separately with a pause, so the front end sees them as separate reads.
+void sendPieces(int fd, const vector<string> &pieces)
+{
+    for (const string &piece : pieces)
+    {
+        ssize_t ignored = write(fd, piece.data(), piece.size());
+        (void)ignored;
+        this_thread::sleep_for(milliseconds(30));
+    }
+}
+
+void checkReassembly()
+{
+    string path = "/tmp/ingestion_parser_check." + to_string(getpid()) + ".sock";
+    IngestionQueue queue(1024, 0, OverflowPolicy::DropOldest, false, 30.0, 48.0);
+    IngestionFrontend frontend(queue, 0, 15, 3600000);
+    if (!frontend.addUnixListener(path))
+    {
+        check(false, "Unix listener");
+        return;
+    }
+    thread loop([&frontend]
+                { frontend.run(); });
+
+    string now = to_string(currentTimestamp());
+    string longLine = "4," + now + ",41.0" + string(300, ' ') + "\n";
+    string longSplit = "5," + now + "," + string(200, '0');
+
+    int fd = connectUnix(path);
+    check(fd >= 0, "connect to front end");
+    if (fd >= 0)
+    {
+        sendPieces(fd, {
+                           "1," + now + ",4",           // line split across reads
+                           "1.5\n2," + now + ",42.5\r\n", // CRLF
+                           longLine,                      // over the line buffer in one read
+                           longSplit,                     // over the line buffer across reads
+                           string(100, '0') + "42\n",
+                           "3," + now + ",43.5\n",
+                           "   \n",                       // blank line
+                           "6," + now + ",nan\n",
+                           "7," + now + ",44.5",          // last line without a newline
+                       });
+        close(fd);
+    }
+
+    FrontendCounters counters;
+    for (int i = 0; i < 100; ++i)
+    {
+        counters = frontend.getCounters();
+        if (counters.readingsParsed + counters.parseErrors >= 7)
+            break;
+        this_thread::sleep_for(milliseconds(20));
+    }
+    frontend.stop();
+    loop.join();
+    unlink(path.c_str());
+
+    vector<SensorReading> readings;
+    queue.popBatch(readings, 100);
+    vector<int> ids;
+    for (const SensorReading &r : readings)
+        ids.push_back(r.sensorID);
+
+    check(ids == vector<int>({1, 2, 3, 7}), "reassembled readings in order");
+    if (readings.size() == 4)
+    {
+        check(readings[0].temperature == 41.5, "split line value");
+        check(readings[1].temperature == 42.5, "CRLF line value");
+        check(readings[3].temperature == 44.5, "unterminated last line value");
+    }
+    // Two over-long lines, the blank line and the nan line.
+    check(counters.parseErrors == 4, "parse errors counted: " + to_string(counters.parseErrors));
+}
+
+void checkOutOfRange()
+{
+    string path = "/tmp/ingestion_parser_check_range." + to_string(getpid()) + ".sock";
+    IngestionQueue queue(1024, 0, OverflowPolicy::DropOldest, false, 30.0, 48.0);
+    IngestionFrontend frontend(queue, 0, 15, 3600000);
+    if (!frontend.addUnixListener(path))
+    {
+        check(false, "Unix listener");
+        return;
+    }
+    thread loop([&frontend]
+                { frontend.run(); });
+
+    string now = to_string(currentTimestamp());
+    int fd = connectUnix(path);
+    if (fd >= 0)
+    {
+        sendPieces(fd, {"16," + now + ",41\n-1," + now + ",41\n3,9223372036854775807,41\n3,0,41\n15," + now + ",41\n"});
+        close(fd);
+    }
+
+    FrontendCounters counters;
+    for (int i = 0; i < 100; ++i)
+    {
+        counters = frontend.getCounters();
+        if (counters.readingsParsed + counters.outOfRangeReadings >= 5)
+            break;
+        this_thread::sleep_for(milliseconds(20));
+    }
+    frontend.stop();
+    loop.join();
+    unlink(path.c_str());
+
+    check(counters.outOfRangeReadings == 4 && counters.readingsParsed == 1, "out-of-range readings are not handed off");
+}
+
+int main()
+{
+    checkParser();
+    checkReassembly();
+    checkOutOfRange();
+
+    if (failures > 0)
+    {
+        cout << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "All ingestion parser checks passed" << endl;
+    return 0;
+}
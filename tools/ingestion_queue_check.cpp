@@ -0,0 +1,229 @@
+// Invariant check for IngestionQueue across every overflow policy, with and without coalescing.
+// Build: g++ -std=c++17 -O2 -pthread -I. -o ingestion_queue_check tools/ingestion_queue_check.cpp IngestionQueue.cpp
+// Usage: ingestion_queue_check (exit status is non-zero on failure)
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "IngestionQueue.hpp"
+
+using namespace std;
+
+const int seed = 42;
+const size_t capacity = 16;
+const size_t overflowAllowance = 4;
+const double normalLow = 30.0;
+const double normalHigh = 48.0;
+
+int failures = 0;
+
+void check(bool condition, const string &message)
+{
+    if (!condition)
+    {
+        cerr << "FAIL: " << message << endl;
+        failures++;
+    }
+}
+
+string policyName(OverflowPolicy policy, bool coalesce)
+{
+    string name = policy == OverflowPolicy::BlockProducer ? "BlockProducer"
+                  : policy == OverflowPolicy::DropOldest  ? "DropOldest"
+                                                          : "ShedNormalFirst";
+    return name + (coalesce ? "+coalesce" : "");
+}
+
+bool isNormal(const SensorReading &reading)
+{
+    return reading.temperature >= normalLow && reading.temperature <= normalHigh;
+}
+
+// Timestamps are unique and increasing, so each sensor's deliveries must be too.
+struct DeliveryLog
+{
+    map<int, int64_t> lastTimestampBySensor;
+    unsigned long long outOfBandDelivered = 0;
+    bool ordered = true;
+
+    void record(const vector<SensorReading> &batch)
+    {
+        for (const SensorReading &reading : batch)
+        {
+            auto found = lastTimestampBySensor.find(reading.sensorID);
+            if (found != lastTimestampBySensor.end() && reading.timestamp <= found->second)
+                ordered = false;
+            lastTimestampBySensor[reading.sensorID] = reading.timestamp;
+            if (!isNormal(reading))
+                outOfBandDelivered++;
+        }
+    }
+};
+
+void checkCounters(IngestionQueue &queue, const string &name)
+{
+    IngestionCounters c = queue.getCounters();
+    check(c.accepted - c.shedNormalQueued - c.droppedOldest - c.droppedOutOfBand == c.delivered + queue.size(),
+          name + ": accepted - evicted == delivered + queued");
+}
+
+void checkRandomized(OverflowPolicy policy, bool coalesce)
+{
+    string name = policyName(policy, coalesce);
+    IngestionQueue queue(capacity, overflowAllowance, policy, coalesce, normalLow, normalHigh);
+    size_t limit = policy == OverflowPolicy::ShedNormalFirst ? capacity + overflowAllowance : capacity;
+
+    default_random_engine gen(seed);
+    uniform_int_distribution<int> sensorDist(1, 24);
+    uniform_int_distribution<int> pick(0, 99);
+    DeliveryLog log;
+    vector<SensorReading> batch;
+    unsigned long long outOfBandPushed = 0;
+    bool bounded = true;
+
+    for (int64_t i = 0; i < 200000; ++i)
+    {
+        SensorReading reading{sensorDist(gen), i, pick(gen) < 20 ? 80.0 : 42.0};
+        if (!isNormal(reading))
+            outOfBandPushed++;
+
+        // Single-threaded BlockProducer must never push into a full queue.
+        if (policy == OverflowPolicy::BlockProducer && queue.size() >= capacity)
+        {
+            batch.clear();
+            queue.popBatch(batch, 1);
+            log.record(batch);
+        }
+        queue.push(reading);
+        if (queue.size() > limit)
+            bounded = false;
+
+        if (pick(gen) < 30)
+        {
+            batch.clear();
+            queue.popBatch(batch, pick(gen) % 4);
+            log.record(batch);
+        }
+    }
+
+    check(bounded, name + ": size stays within " + to_string(limit));
+    check(queue.getCounters().highWaterMark <= limit, name + ": high water mark within limit");
+    checkCounters(queue, name);
+
+    IngestionCounters c = queue.getCounters();
+    batch.clear();
+    queue.popBatch(batch, static_cast<size_t>(-1));
+    log.record(batch);
+    check(log.ordered, name + ": per-sensor delivery order");
+    if (policy == OverflowPolicy::ShedNormalFirst)
+    {
+        check(log.outOfBandDelivered == outOfBandPushed - c.droppedOutOfBand,
+              name + ": out-of-band readings are only lost through droppedOutOfBand");
+    }
+    else if (!coalesce)
+    {
+        check(c.coalesced == 0, name + ": no coalescing when disabled");
+    }
+}
+
+// A normal reading arriving after a queued spike must not coalesce ahead of it.
+void checkCoalesceAfterSpike(OverflowPolicy policy)
+{
+    string name = policyName(policy, true) + " after spike";
+    IngestionQueue queue(3, overflowAllowance, policy, true, normalLow, normalHigh);
+    queue.push(SensorReading{1, 1, 42.0});
+    queue.push(SensorReading{1, 2, 80.0});
+    queue.push(SensorReading{2, 3, 42.0});
+    if (policy != OverflowPolicy::BlockProducer)
+        queue.push(SensorReading{1, 4, 43.0});
+
+    vector<SensorReading> batch;
+    queue.popBatch(batch, 10);
+    DeliveryLog log;
+    log.record(batch);
+    check(log.ordered, name + ": sensor order preserved");
+    check(queue.getCounters().coalesced == 0, name + ": no coalescing across a spike");
+
+    // With no spike in between, the newest normal reading replaces the queued one in place.
+    IngestionQueue plain(2, overflowAllowance, policy, true, normalLow, normalHigh);
+    plain.push(SensorReading{1, 1, 42.0});
+    plain.push(SensorReading{2, 2, 42.0});
+    plain.push(SensorReading{1, 3, 43.0});
+    batch.clear();
+    plain.popBatch(batch, 10);
+    check(batch.size() == 2 && batch[0].sensorID == 1 && batch[0].timestamp == 3 && batch[1].sensorID == 2,
+          policyName(policy, true) + ": coalesces into the queued reading of the same sensor");
+    checkCounters(plain, policyName(policy, true) + " coalesce");
+}
+
+void checkBlockingProducer(bool coalesce)
+{
+    string name = policyName(OverflowPolicy::BlockProducer, coalesce) + " threaded";
+    IngestionQueue queue(capacity, overflowAllowance, OverflowPolicy::BlockProducer, coalesce, normalLow, normalHigh);
+    const int64_t total = 100000;
+
+    thread producer([&queue, total]
+                    {
+        default_random_engine gen(seed);
+        uniform_int_distribution<int> sensorDist(1, 24);
+        uniform_int_distribution<int> pick(0, 99);
+        vector<SensorReading> chunk;
+        for (int64_t i = 0; i < total; ++i)
+        {
+            chunk.push_back(SensorReading{sensorDist(gen), i, pick(gen) < 20 ? 80.0 : 42.0});
+            if (chunk.size() == 8)
+            {
+                queue.pushBatch(chunk.data(), chunk.size());
+                chunk.clear();
+            }
+        }
+        queue.pushBatch(chunk.data(), chunk.size()); });
+
+    DeliveryLog log;
+    vector<SensorReading> batch;
+    bool bounded = true;
+    unsigned long long received = 0;
+    while (true)
+    {
+        if (queue.size() > capacity)
+            bounded = false;
+        batch.clear();
+        received += queue.waitPopBatch(batch, 5, 10);
+        log.record(batch);
+        IngestionCounters c = queue.getCounters();
+        if (c.accepted + c.coalesced == static_cast<unsigned long long>(total) && queue.size() == 0)
+            break;
+    }
+    producer.join();
+
+    IngestionCounters c = queue.getCounters();
+    check(bounded && c.highWaterMark <= capacity, name + ": size stays within capacity");
+    check(log.ordered, name + ": per-sensor delivery order");
+    check(c.droppedOldest == 0 && c.shedNormalQueued == 0 && c.shedNormalIncoming == 0 && c.droppedOutOfBand == 0,
+          name + ": nothing is dropped");
+    check(received == c.delivered, name + ": delivered counter matches");
+    checkCounters(queue, name);
+}
+
+int main()
+{
+    const OverflowPolicy policies[] = {OverflowPolicy::BlockProducer, OverflowPolicy::DropOldest, OverflowPolicy::ShedNormalFirst};
+    for (OverflowPolicy policy : policies)
+    {
+        checkRandomized(policy, false);
+        checkRandomized(policy, true);
+        checkCoalesceAfterSpike(policy);
+    }
+    checkBlockingProducer(false);
+    checkBlockingProducer(true);
+
+    if (failures > 0)
+    {
+        cout << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "All ingestion queue checks passed" << endl;
+    return 0;
+}